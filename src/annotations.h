@@ -25,3 +25,22 @@
 #else
 #define TS_USED
 #endif
+
+/*
+ * Compile a function several times for different instruction set extensions,
+ * and choose the best one supported by the running CPU through an ifunc
+ * resolver. We build with conservative target flags, so the autovectorized
+ * hot loops are otherwise limited to the baseline SSE2 on x86-64. This allows
+ * them to use the full vector width of the host while still shipping one
+ * binary. Requires ELF for the ifunc support, and is only useful on x86-64
+ * where the baseline is narrower than the common hardware.
+ * Supported since GCC 6 and clang 14.
+ */
+#ifdef __has_attribute
+#if defined(__x86_64__) && defined(__ELF__) && __has_attribute(target_clones)
+#define TS_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef TS_TARGET_CLONES
+#define TS_TARGET_CLONES
+#endif
@@ -0,0 +1,147 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+#pragma once
+
+#include <postgres.h>
+
+#include <port/pg_bitutils.h>
+
+/*
+ * Helpers for whole-bitmap operations on the vectorized qual result bitmaps.
+ *
+ * The bitmaps are small (one bit per batch row), but they are touched for
+ * every batch, so it pays to keep these operations as simple word-wise loops
+ * with no data-dependent conditions, which the compiler can turn into full
+ * width vector instructions. The loops are additionally unrolled four words
+ * at a time, so that on the compilers and architectures where they are not
+ * autovectorized, the independent word operations still overlap instead of
+ * retiring one at a time.
+ */
+
+#define BITMAP_UNROLL 4
+
+static pg_attribute_always_inline void
+bitmap_zero(uint64 *restrict bitmap, size_t num_words)
+{
+	size_t i = 0;
+	for (; i + BITMAP_UNROLL <= num_words; i += BITMAP_UNROLL)
+	{
+		for (size_t j = 0; j < BITMAP_UNROLL; j++)
+		{
+			bitmap[i + j] = 0;
+		}
+	}
+	for (; i < num_words; i++)
+	{
+		bitmap[i] = 0;
+	}
+}
+
+static pg_attribute_always_inline void
+bitmap_set_all(uint64 *restrict bitmap, size_t num_words)
+{
+	size_t i = 0;
+	for (; i + BITMAP_UNROLL <= num_words; i += BITMAP_UNROLL)
+	{
+		for (size_t j = 0; j < BITMAP_UNROLL; j++)
+		{
+			bitmap[i + j] = ~0ULL;
+		}
+	}
+	for (; i < num_words; i++)
+	{
+		bitmap[i] = ~0ULL;
+	}
+}
+
+static pg_attribute_always_inline void
+bitmap_and(uint64 *restrict dst, const uint64 *restrict src, size_t num_words)
+{
+	size_t i = 0;
+	for (; i + BITMAP_UNROLL <= num_words; i += BITMAP_UNROLL)
+	{
+		for (size_t j = 0; j < BITMAP_UNROLL; j++)
+		{
+			dst[i + j] &= src[i + j];
+		}
+	}
+	for (; i < num_words; i++)
+	{
+		dst[i] &= src[i];
+	}
+}
+
+static pg_attribute_always_inline void
+bitmap_or(uint64 *restrict dst, const uint64 *restrict src, size_t num_words)
+{
+	size_t i = 0;
+	for (; i + BITMAP_UNROLL <= num_words; i += BITMAP_UNROLL)
+	{
+		for (size_t j = 0; j < BITMAP_UNROLL; j++)
+		{
+			dst[i + j] |= src[i + j];
+		}
+	}
+	for (; i < num_words; i++)
+	{
+		dst[i] |= src[i];
+	}
+}
+
+#undef BITMAP_UNROLL
+
+/*
+ * Find the position of the first set bit at position >= start. Returns total
+ * if there is none. The bits at positions [total; padded end of bitmap) must
+ * be zero, which is how the vectorized qual result bitmap is initialized.
+ */
+static inline uint16
+bitmap_next_set_bit(const uint64 *bitmap, uint16 start, uint16 total)
+{
+	uint16 word_index = start / 64;
+	const uint16 total_words = (total + 63) / 64;
+	const uint64 first_word = bitmap[word_index] >> (start % 64);
+	if (first_word != 0)
+	{
+		return start + pg_rightmost_one_pos64(first_word);
+	}
+
+	for (word_index++; word_index < total_words; word_index++)
+	{
+		if (bitmap[word_index] != 0)
+		{
+			return word_index * 64 + pg_rightmost_one_pos64(bitmap[word_index]);
+		}
+	}
+
+	return total;
+}
+
+/*
+ * Find the position of the last set bit at position <= start. Returns -1 if
+ * there is none.
+ */
+static inline int
+bitmap_prev_set_bit(const uint64 *bitmap, uint16 start)
+{
+	int word_index = start / 64;
+	/* Move the bit at `start` to the topmost position, dropping higher bits. */
+	const uint64 first_word = bitmap[word_index] << (63 - start % 64);
+	if (first_word != 0)
+	{
+		return start - (63 - pg_leftmost_one_pos64(first_word));
+	}
+
+	for (word_index--; word_index >= 0; word_index--)
+	{
+		if (bitmap[word_index] != 0)
+		{
+			return word_index * 64 + pg_leftmost_one_pos64(bitmap[word_index]);
+		}
+	}
+
+	return -1;
+}
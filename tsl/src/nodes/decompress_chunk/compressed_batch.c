@@ -16,6 +16,7 @@
 #include "compression/compression.h"
 #include "debug_assert.h"
 #include "guc.h"
+#include "nodes/decompress_chunk/bitmap_ops.h"
 #include "nodes/decompress_chunk/compressed_batch.h"
 #include "nodes/decompress_chunk/vector_predicates.h"
 #include "nodes/decompress_chunk/vector_quals.h"
@@ -32,6 +33,8 @@ typedef struct CompressedBatchVectorQualState
 	DecompressContext *dcontext;
 } CompressedBatchVectorQualState;
 
+static FixedStoreFunction *get_fixed_store_function(int value_bytes, bool nullable);
+
 /*
  * Create a single-value ArrowArray of an arithmetic type. This is a specialized
  * function because arithmetic types have a particular layout of ArrowArrays.
@@ -48,21 +51,34 @@ make_single_value_arrow_arithmetic(Oid arithmetic_type, Datum datum, bool isnull
 		uint64 values_buffer[8];
 	};
 
-	struct ArrowWithBuffers *with_buffers = palloc0(sizeof(struct ArrowWithBuffers));
+	/*
+	 * Note that we don't use palloc0 here. This function runs once per
+	 * default-valued column per batch, and most of the allocation is the
+	 * padded value buffer which doesn't have to be zeroed, so we initialize
+	 * only the parts that are actually read.
+	 */
+	struct ArrowWithBuffers *with_buffers = palloc(sizeof(struct ArrowWithBuffers));
 	ArrowArray *arrow = &with_buffers->arrow;
-	arrow->length = 1;
-	arrow->buffers = (const void **) with_buffers->arrow_buffers_array_storage;
-	arrow->n_buffers = 2;
+	*arrow = (ArrowArray){
+		.length = 1,
+		.n_buffers = 2,
+		.buffers = (const void **) with_buffers->arrow_buffers_array_storage,
+	};
 	arrow->buffers[0] = with_buffers->validity_buffer;
 	arrow->buffers[1] = with_buffers->values_buffer;
+	with_buffers->validity_buffer[0] = 0;
 
 	if (isnull)
 	{
 		/*
-		 * The validity bitmap was initialized to invalid on allocation, and
-		 * the Datum might be invalid if the value is null (important on i386
-		 * where it might be pass-by-reference), so don't read it.
+		 * The validity bitmap was initialized to invalid above, and the Datum
+		 * might be invalid if the value is null (important on i386 where it
+		 * might be pass-by-reference), so don't read it. Zero out the first
+		 * value word instead, because the vectorized predicates compute over
+		 * the values regardless of validity and mask the result afterwards,
+		 * so they must not read uninitialized memory.
 		 */
+		with_buffers->values_buffer[0] = 0;
 		arrow->null_count = 1;
 		return arrow;
 	}
@@ -109,22 +125,33 @@ make_single_value_arrow_text(Datum datum, bool isnull)
 		uint64 values_buffer[8];
 	};
 
-	struct ArrowWithBuffers *with_buffers = palloc0(sizeof(struct ArrowWithBuffers));
+	/*
+	 * Same as for the arithmetic types, initialize only the parts that are
+	 * actually read instead of using palloc0.
+	 */
+	struct ArrowWithBuffers *with_buffers = palloc(sizeof(struct ArrowWithBuffers));
 	ArrowArray *arrow = &with_buffers->arrow;
-	arrow->length = 1;
-	arrow->buffers = (const void **) with_buffers->arrow_buffers_array_storage;
-	arrow->n_buffers = 3;
+	*arrow = (ArrowArray){
+		.length = 1,
+		.n_buffers = 3,
+		.buffers = (const void **) with_buffers->arrow_buffers_array_storage,
+	};
 	arrow->buffers[0] = with_buffers->validity_buffer;
 	arrow->buffers[1] = with_buffers->offsets_buffer;
 	arrow->buffers[2] = with_buffers->values_buffer;
+	with_buffers->validity_buffer[0] = 0;
+	with_buffers->offsets_buffer[0] = 0;
 
 	if (isnull)
 	{
 		/*
-		 * The validity bitmap was initialized to invalid on allocation, and
-		 * the Datum might be invalid if the value is null (important on i386
-		 * where it might be pass-by-reference), so don't read it.
+		 * The validity bitmap was initialized to invalid above, and the Datum
+		 * might be invalid if the value is null (important on i386 where it
+		 * might be pass-by-reference), so don't read it. The end offset makes
+		 * the row zero-length, so the text predicates don't read the value
+		 * body.
 		 */
+		with_buffers->offsets_buffer[1] = 0;
 		arrow->null_count = 1;
 		return arrow;
 	}
@@ -175,11 +202,14 @@ decompress_column(DecompressContext *dcontext, DecompressBatchState *batch_state
 {
 	CompressionColumnDescription *column_description = &dcontext->compressed_chunk_columns[i];
 	CompressedColumnValues *column_values = &batch_state->compressed_columns[i];
-	column_values->arrow = NULL;
-	const AttrNumber attr = AttrNumberGetAttrOffset(column_description->custom_scan_attno);
-	column_values->output_value = &compressed_batch_current_tuple(batch_state)->tts_values[attr];
-	column_values->output_isnull = &compressed_batch_current_tuple(batch_state)->tts_isnull[attr];
-	const int value_bytes = get_typlen(column_description->typid);
+	/* The output pointers were initialized once in compressed_batch_lazy_init. */
+	Assert(column_values->output_value ==
+		   &compressed_batch_current_tuple(batch_state)
+				->tts_values[AttrNumberGetAttrOffset(column_description->custom_scan_attno)]);
+	Assert(column_values->arrow == NULL);
+	/* The type length was already looked up once at executor initialization. */
+	const int value_bytes = column_description->value_bytes;
+	Assert(value_bytes == get_typlen(column_description->typid));
 	Assert(value_bytes != 0);
 
 	bool isnull;
@@ -280,8 +310,19 @@ decompress_column(DecompressContext *dcontext, DecompressBatchState *batch_state
 			VARHDRSZ + (arrow->dictionary ? get_max_text_datum_size(arrow->dictionary) :
 											get_max_text_datum_size(arrow));
 
-		*column_values->output_value =
-			PointerGetDatum(MemoryContextAlloc(batch_state->per_batch_context, maxbytes));
+		if (maxbytes > column_values->output_datum_scratch_bytes)
+		{
+			if (column_values->output_datum_scratch != NULL)
+			{
+				pfree(column_values->output_datum_scratch);
+			}
+			column_values->output_datum_scratch =
+				MemoryContextAlloc(MemoryContextGetParent(batch_state->per_batch_context),
+								   maxbytes);
+			column_values->output_datum_scratch_bytes = maxbytes;
+		}
+
+		*column_values->output_value = PointerGetDatum(column_values->output_datum_scratch);
 
 		/*
 		 * Set up the datum conversion based on whether we use the dictionary.
@@ -318,47 +359,44 @@ compressed_batch_get_arrow_array(VectorQualState *vqstate, Expr *expr, bool *is_
 	CompressedBatchVectorQualState *cbvqstate = (CompressedBatchVectorQualState *) vqstate;
 	DecompressContext *dcontext = cbvqstate->dcontext;
 	DecompressBatchState *batch_state = cbvqstate->batch_state;
-	CompressionColumnDescription *column_description = NULL;
 	TupleTableSlot *compressed_slot = vqstate->slot;
 	const Var *var = castNode(Var, expr);
-	int column_index = 0;
+	int column_index = -1;
 
-	for (; column_index < dcontext->num_data_columns; column_index++)
+	if (var->varno == INDEX_VAR)
 	{
-		column_description = &dcontext->compressed_chunk_columns[column_index];
-		if (var->varno == INDEX_VAR)
+		/*
+		 * Reference into custom scan tlist, happens when we are using a
+		 * non-default custom scan tuple.
+		 */
+		if (var->varattno > 0 &&
+			var->varattno <= dcontext->custom_scan_slot->tts_tupleDescriptor->natts)
 		{
-			/*
-			 * Reference into custom scan tlist, happens when we are using a
-			 * non-default custom scan tuple.
-			 */
-			if (column_description->custom_scan_attno == var->varattno)
-			{
-				break;
-			}
+			column_index = dcontext->column_index_by_custom_attno[var->varattno];
 		}
-		else
+	}
+	else
+	{
+		/*
+		 * Reference into uncompressed chunk tuple.
+		 *
+		 * Note that this is somewhat redundant, because this branch is
+		 * taken when we do not use a custom scan tuple, and in this case
+		 * the custom scan attno is the same as the uncompressed chunk attno,
+		 * so the above branch would do as well. This difference might
+		 * become relevant in the future, if we stop outputting the
+		 * columns that are needed only for the vectorized quals.
+		 */
+		if (var->varattno > 0 && var->varattno <= dcontext->uncompressed_chunk_tdesc->natts)
 		{
-			/*
-			 * Reference into uncompressed chunk tuple.
-			 *
-			 * Note that this is somewhat redundant, because this branch is
-			 * taken when we do not use a custom scan tuple, and in this case
-			 * the custom scan attno is the same as the uncompressed chunk attno,
-			 * so the above branch would do as well. This difference might
-			 * become relevant in the future, if we stop outputting the
-			 * columns that are needed only for the vectorized quals.
-			 */
-			if (column_description->uncompressed_chunk_attno == var->varattno)
-			{
-				break;
-			}
+			column_index = dcontext->column_index_by_chunk_attno[var->varattno];
 		}
 	}
-	Ensure(column_index < dcontext->num_data_columns,
-		   "decompressed column %d not found in batch",
-		   var->varattno);
-	Assert(column_description != NULL);
+	Ensure(column_index >= 0, "decompressed column %d not found in batch", var->varattno);
+	Assert(column_index < dcontext->num_data_columns);
+
+	CompressionColumnDescription *column_description =
+		&dcontext->compressed_chunk_columns[column_index];
 	Assert(column_description->typid == var->vartype);
 	Ensure(column_description->type == COMPRESSED_COLUMN,
 		   "only compressed columns are supported in vectorized quals");
@@ -458,7 +496,14 @@ translate_bitmap_from_dictionary(const ArrowArray *arrow, const uint64 *dict_res
 #undef INNER_LOOP
 }
 
-static void
+/*
+ * Compute a single plain (non-boolean) vectorized qual and AND it into the
+ * result bitmap. Returns the summary of the result bitmap after this qual was
+ * applied. Since the quals are ANDed into the shared bitmap, this is the
+ * summary of the conjunction computed so far, and the caller can use the
+ * summary of the last qual as the final one without recomputing it.
+ */
+static VectorQualSummary
 compute_plain_qual(VectorQualState *vqstate, TupleTableSlot *slot, Node *qual,
 				   uint64 *restrict result)
 {
@@ -475,21 +520,16 @@ compute_plain_qual(VectorQualState *vqstate, TupleTableSlot *slot, Node *qual,
 			 * strict comparison with stable expression that evaluates to null.
 			 * No rows pass.
 			 */
-			const size_t n_batch_result_words = (vqstate->num_results + 63) / 64;
-			for (size_t i = 0; i < n_batch_result_words; i++)
-			{
-				result[i] = 0;
-			}
-		}
-		else
-		{
-			/*
-			 * This is a constant true qual, every row passes and we can
-			 * just ignore it. No idea how it can happen though.
-			 */
-			Assert(false);
+			bitmap_zero(result, (vqstate->num_results + 63) / 64);
+			return NoRowsPass;
 		}
-		return;
+
+		/*
+		 * This is a constant true qual, every row passes and we can
+		 * just ignore it. No idea how it can happen though.
+		 */
+		Assert(false);
+		return get_vector_qual_summary(result, vqstate->num_results);
 	}
 
 	/*
@@ -618,10 +658,7 @@ compute_plain_qual(VectorQualState *vqstate, TupleTableSlot *slot, Node *qual,
 		const uint64 *validity = (const uint64 *) vector->buffers[0];
 		if (validity)
 		{
-			for (size_t i = 0; i < n_vector_result_words; i++)
-			{
-				predicate_result[i] &= validity[i];
-			}
+			bitmap_and(predicate_result, validity, n_vector_result_words);
 		}
 		else
 		{
@@ -638,94 +675,91 @@ compute_plain_qual(VectorQualState *vqstate, TupleTableSlot *slot, Node *qual,
 			 * We had a default value for the compressed column, and it
 			 * didn't pass the predicate, so the entire batch didn't pass.
 			 */
-			const size_t n_batch_result_words = (vqstate->num_results + 63) / 64;
-			for (size_t i = 0; i < n_batch_result_words; i++)
-			{
-				result[i] = 0;
-			}
+			bitmap_zero(result, (vqstate->num_results + 63) / 64);
+			return NoRowsPass;
 		}
 	}
+
+	return get_vector_qual_summary(result, vqstate->num_results);
 }
 
-static void compute_one_qual(VectorQualState *vqstate, TupleTableSlot *compressed_slot, Node *qual,
-							 uint64 *restrict result);
-static void
+static VectorQualSummary compute_one_qual(VectorQualState *vqstate,
+										  TupleTableSlot *compressed_slot, Node *qual,
+										  uint64 *restrict result);
+static VectorQualSummary
 compute_qual_conjunction(VectorQualState *vqstate, TupleTableSlot *compressed_slot, List *quals,
 						 uint64 *restrict result)
 {
+	VectorQualSummary summary = AllRowsPass;
 	ListCell *lc;
 	foreach (lc, quals)
 	{
-		compute_one_qual(vqstate, compressed_slot, lfirst(lc), result);
-		if (get_vector_qual_summary(result, vqstate->num_results) == NoRowsPass)
+		summary = compute_one_qual(vqstate, compressed_slot, lfirst(lc), result);
+		if (summary == NoRowsPass)
 		{
 			/*
 			 * Exit early if no rows pass already. This might allow us to avoid
 			 * reading the columns required for the subsequent quals.
 			 */
-			return;
+			return NoRowsPass;
 		}
 	}
+
+	/*
+	 * The quals are ANDed into the shared result bitmap, so the summary after
+	 * the last qual is the summary of the entire conjunction.
+	 */
+	return summary;
 }
 
-static void
+static VectorQualSummary
 compute_qual_disjunction(VectorQualState *vqstate, TupleTableSlot *compressed_slot, List *quals,
 						 uint64 *restrict result)
 {
 	const size_t n_rows = vqstate->num_results;
 	const size_t n_result_words = (n_rows + 63) / 64;
 	uint64 *or_result = palloc(sizeof(uint64) * n_result_words);
-	for (size_t i = 0; i < n_result_words; i++)
-	{
-		or_result[i] = 0;
-	}
+	bitmap_zero(or_result, n_result_words);
 
 	uint64 *one_qual_result = palloc(sizeof(uint64) * n_result_words);
 
 	ListCell *lc;
 	foreach (lc, quals)
 	{
-		for (size_t i = 0; i < n_result_words; i++)
-		{
-			one_qual_result[i] = (uint64) -1;
-		}
+		bitmap_set_all(one_qual_result, n_result_words);
 		compute_one_qual(vqstate, compressed_slot, lfirst(lc), one_qual_result);
-		for (size_t i = 0; i < n_result_words; i++)
-		{
-			or_result[i] |= one_qual_result[i];
-		}
+		bitmap_or(or_result, one_qual_result, n_result_words);
 
 		if (get_vector_qual_summary(or_result, n_rows) == AllRowsPass)
 		{
 			/*
 			 * We can sometimes avoing reading the columns required for the
-			 * rest of conditions if we break out early here.
+			 * rest of conditions if we break out early here. The OR result is
+			 * all ones, so ANDing it into the shared bitmap would not change
+			 * it, and we can skip that as well.
 			 */
-			return;
+			return get_vector_qual_summary(result, n_rows);
 		}
 	}
 
-	for (size_t i = 0; i < n_result_words; i++)
-	{
-		result[i] &= or_result[i];
-	}
+	bitmap_and(result, or_result, n_result_words);
+
+	return get_vector_qual_summary(result, n_rows);
 }
 
-static void
+static VectorQualSummary
 compute_one_qual(VectorQualState *vqstate, TupleTableSlot *compressed_slot, Node *qual,
 				 uint64 *restrict result)
 {
 	if (!IsA(qual, BoolExpr))
 	{
-		compute_plain_qual(vqstate, compressed_slot, qual, result);
-		return;
+		return compute_plain_qual(vqstate, compressed_slot, qual, result);
 	}
 
 	BoolExpr *boolexpr = castNode(BoolExpr, qual);
 	if (boolexpr->boolop == AND_EXPR)
 	{
-		compute_qual_conjunction(vqstate, compressed_slot, boolexpr->args, result);
-		return;
+		return compute_qual_conjunction(vqstate, compressed_slot, boolexpr->args, result);
 	}
 
 	/*
@@ -733,7 +767,7 @@ compute_one_qual(VectorQualState *vqstate, TupleTableSlot *compressed_slot, Node
 	 * NOT and consider it non-vectorizable at planning time. So only OR is left.
 	 */
 	Ensure(boolexpr->boolop == OR_EXPR, "expected OR");
-	compute_qual_disjunction(vqstate, compressed_slot, boolexpr->args, result);
+	return compute_qual_disjunction(vqstate, compressed_slot, boolexpr->args, result);
 }
 
 /*
@@ -750,7 +784,14 @@ vector_qual_compute(VectorQualState *vqstate)
 	 */
 	const size_t n_rows = vqstate->num_results;
 	const int bitmap_bytes = sizeof(uint64) * ((n_rows + 63) / 64);
-	vqstate->vector_qual_result = MemoryContextAlloc(vqstate->per_vector_mcxt, bitmap_bytes);
+	if (vqstate->vector_qual_result == NULL)
+	{
+		/*
+		 * The caller can provide reusable storage for the result bitmap, like
+		 * the compressed batch does, to avoid this allocation per vector.
+		 */
+		vqstate->vector_qual_result = MemoryContextAlloc(vqstate->per_vector_mcxt, bitmap_bytes);
+	}
 	memset(vqstate->vector_qual_result, 0xFF, bitmap_bytes);
 
 	if (n_rows % 64 != 0)
@@ -765,14 +806,15 @@ vector_qual_compute(VectorQualState *vqstate)
 	}
 
 	/*
-	 * Compute the quals.
+	 * Compute the quals. The summary is tracked as the quals are computed, so
+	 * we don't have to scan the result bitmap again here. In particular, the
+	 * common case of a single vectorized qual makes exactly one pass over the
+	 * bitmap.
 	 */
-	compute_qual_conjunction(vqstate,
-							 vqstate->slot,
-							 vqstate->vectorized_quals_constified,
-							 vqstate->vector_qual_result);
-
-	return get_vector_qual_summary(vqstate->vector_qual_result, n_rows);
+	return compute_qual_conjunction(vqstate,
+									vqstate->slot,
+									vqstate->vectorized_quals_constified,
+									vqstate->vector_qual_result);
 }
 
 /*
@@ -856,6 +898,48 @@ compressed_batch_lazy_init(DecompressContext *dcontext, DecompressBatchState *ba
 	 */
 	*((const TupleTableSlotOps **) &slot->tts_ops) = &TTSOpsVirtual;
 	slot->tts_ops->init(slot);
+
+	/*
+	 * Allocate the structure-of-arrays view of the fixed-width columns. All
+	 * arrays are placed into one allocation back-to-back, so that a walk over
+	 * the column indexes streams them sequentially through the cache.
+	 */
+	const int num_data_columns = dcontext->num_data_columns;
+	char *soa_storage = palloc(num_data_columns * (4 * sizeof(void *) + sizeof(Datum *)) +
+							   num_data_columns * sizeof(uint8));
+	batch_state->fixed_values = (const char **) soa_storage;
+	soa_storage += num_data_columns * sizeof(void *);
+	batch_state->fixed_validity = (const uint64 **) soa_storage;
+	soa_storage += num_data_columns * sizeof(void *);
+	batch_state->fixed_output_value = (Datum **) soa_storage;
+	soa_storage += num_data_columns * sizeof(Datum *);
+	batch_state->fixed_output_isnull = (bool **) soa_storage;
+	soa_storage += num_data_columns * sizeof(void *);
+	batch_state->fixed_store_fn = (FixedStoreFunction **) soa_storage;
+	soa_storage += num_data_columns * sizeof(void *);
+	batch_state->fixed_value_bytes = (uint8 *) soa_storage;
+
+	/*
+	 * Initialize the per-column fields that do not change between batches, so
+	 * that the per-batch code only has to reset the fields that actually vary.
+	 * The output pointers reference the tts_values/tts_isnull arrays allocated
+	 * above, which stay in place for the lifetime of the batch state, so the
+	 * pointers stay valid even when the batch states array is enlarged. The
+	 * decompression type of a segmentby column is always DT_Scalar.
+	 */
+	for (int i = 0; i < num_data_columns; i++)
+	{
+		const CompressionColumnDescription *column_description =
+			&dcontext->compressed_chunk_columns[i];
+		CompressedColumnValues *column_values = &batch_state->compressed_columns[i];
+		const AttrNumber attr = AttrNumberGetAttrOffset(column_description->custom_scan_attno);
+		column_values->output_value = &slot->tts_values[attr];
+		column_values->output_isnull = &slot->tts_isnull[attr];
+		if (column_description->type == SEGMENTBY_COLUMN)
+		{
+			column_values->decompression_type = DT_Scalar;
+		}
+	}
 }
 
 /*
@@ -912,13 +996,15 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 				 */
 				Assert(i < dcontext->num_data_columns);
 				CompressedColumnValues *column_values = &batch_state->compressed_columns[i];
-				column_values->decompression_type = DT_Scalar;
-				AttrNumber attr = AttrNumberGetAttrOffset(column_description->custom_scan_attno);
-				Datum *output_value = &decompressed_tuple->tts_values[attr];
-				bool *output_isnull = &decompressed_tuple->tts_isnull[attr];
-				column_values->output_value = output_value;
-				column_values->output_isnull = output_isnull;
-				column_values->arrow = NULL;
+				/*
+				 * The decompression type, the output pointers and the arrow
+				 * array (always NULL for a segmentby column) were initialized
+				 * once in compressed_batch_lazy_init.
+				 */
+				Assert(column_values->decompression_type == DT_Scalar);
+				Assert(column_values->arrow == NULL);
+				Datum *output_value = column_values->output_value;
+				bool *output_isnull = column_values->output_isnull;
 
 				*output_value = slot_getattr(compressed_slot,
 											 column_description->compressed_scan_attno,
@@ -983,6 +1069,27 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 		}
 	}
 
+	/*
+	 * The result bitmap of the vectorized quals is reused across batches,
+	 * because an allocation per batch adds up for scans with small batches.
+	 * Grow the reusable storage if the current batch doesn't fit into it.
+	 */
+	if (dcontext->vectorized_quals_constified != NIL)
+	{
+		const uint16 bitmap_words = (batch_state->total_batch_rows + 63) / 64;
+		if (bitmap_words > batch_state->vector_qual_storage_words)
+		{
+			if (batch_state->vector_qual_result_storage != NULL)
+			{
+				pfree(batch_state->vector_qual_result_storage);
+			}
+			batch_state->vector_qual_result_storage =
+				MemoryContextAlloc(MemoryContextGetParent(batch_state->per_batch_context),
+								   sizeof(uint64) * bitmap_words);
+			batch_state->vector_qual_storage_words = bitmap_words;
+		}
+	}
+
 	CompressedBatchVectorQualState cbvqstate = {
 		.vqstate = {
 			.vectorized_quals_constified = dcontext->vectorized_quals_constified,
@@ -990,6 +1097,7 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 			.per_vector_mcxt = batch_state->per_batch_context,
 			.slot = compressed_slot,
 			.get_arrow_array = compressed_batch_get_arrow_array,
+			.vector_qual_result = batch_state->vector_qual_result_storage,
 		},
 		.batch_state = batch_state,
 		.dcontext = dcontext,
@@ -1000,6 +1108,7 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 		vqstate->vectorized_quals_constified != NIL ? vector_qual_compute(vqstate) : AllRowsPass;
 
 	batch_state->vector_qual_result = vqstate->vector_qual_result;
+	batch_state->vector_qual_no_rows_pass = vector_qual_summary == NoRowsPass;
 
 	if (vector_qual_summary == NoRowsPass && !dcontext->batch_sorted_merge)
 	{
@@ -1025,6 +1134,9 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 		 * we have to decompress the rest of the compressed columns.
 		 */
 		const int num_data_columns = dcontext->num_data_columns;
+		bool only_fixed_columns = true;
+		bool have_iterator_columns = false;
+		uint16 num_fixed_columns = 0;
 		for (int i = 0; i < num_data_columns; i++)
 		{
 			CompressedColumnValues *column_values = &batch_state->compressed_columns[i];
@@ -1033,7 +1145,36 @@ compressed_batch_set_compressed_tuple(DecompressContext *dcontext,
 				decompress_column(dcontext, batch_state, compressed_slot, i);
 				Assert(column_values->decompression_type != DT_Invalid);
 			}
+
+			/*
+			 * Check whether the entire batch can be materialized with the
+			 * specialized fixed-width loop, and fill the structure-of-arrays
+			 * view of the fixed-width columns for it. Note that the
+			 * fixed-width by-reference types that don't fit into a Datum are
+			 * excluded, because they are materialized by reference and not by
+			 * value.
+			 */
+			const DecompressionType type = column_values->decompression_type;
+			if (type > 0 && type <= SIZEOF_DATUM)
+			{
+				batch_state->fixed_values[num_fixed_columns] = column_values->buffers[1];
+				batch_state->fixed_validity[num_fixed_columns] = column_values->buffers[0];
+				batch_state->fixed_output_value[num_fixed_columns] = column_values->output_value;
+				batch_state->fixed_output_isnull[num_fixed_columns] = column_values->output_isnull;
+				batch_state->fixed_store_fn[num_fixed_columns] =
+					get_fixed_store_function(type, column_values->buffers[0] != NULL);
+				batch_state->fixed_value_bytes[num_fixed_columns] = type;
+				num_fixed_columns++;
+			}
+			else
+			{
+				only_fixed_columns = only_fixed_columns && type == DT_Scalar;
+				have_iterator_columns = have_iterator_columns || type == DT_Iterator;
+			}
 		}
+		batch_state->only_fixed_columns = only_fixed_columns;
+		batch_state->have_iterator_columns = have_iterator_columns;
+		batch_state->num_fixed_columns = num_fixed_columns;
 
 		/*
 		 * If all rows pass, no need to test the vector qual for each row. This
@@ -1062,6 +1203,186 @@ store_text_datum(CompressedColumnValues *column_values, int arrow_row)
 		   value_bytes);
 }
 
+/*
+ * Implementation of storing one row of a fixed-width by-value arrow column
+ * into the decompressed slot. The value width and the nullability are
+ * compile-time constants in the specializations below, so that each of them
+ * compiles down to a single typed load, and no per-row dispatch on the width
+ * is needed. The columns with no validity bitmap don't pay for the null bit
+ * extraction at all, and for the nullable columns the bit is extracted with
+ * a branchless shift and mask, without the per-row NULL check that
+ * arrow_row_is_valid() performs.
+ *
+ * The value is read with a fixed-size memcpy of exactly the value width,
+ * which the compiler turns into a single typed load. Reading a full Datum
+ * regardless of the width would be an out-of-bounds read for the last row of
+ * a narrow column, and the exact-width loads are also friendlier to the
+ * compiler's alias analysis. The loads are naturally aligned because the
+ * offset is a multiple of the width, but we still spell them as memcpy
+ * following the project convention for type-punned reads. The value is
+ * zero-extended to the Datum width, which is fine because the high Datum
+ * bytes are truncated away again when the value is read back through the
+ * DatumGet conversion of the narrow type.
+ */
+static pg_attribute_always_inline void
+store_fixed_value_impl(const char *values, const uint64 *validity, uint16 arrow_row,
+					   Datum *output_value, bool *output_isnull, const int value_bytes,
+					   const bool nullable)
+{
+	const char *restrict src = &values[value_bytes * arrow_row];
+	switch (value_bytes)
+	{
+		case 1:
+		{
+			uint8 value;
+			memcpy(&value, src, 1);
+			*output_value = UInt8GetDatum(value);
+			break;
+		}
+		case 2:
+		{
+			uint16 value;
+			memcpy(&value, src, 2);
+			*output_value = UInt16GetDatum(value);
+			break;
+		}
+		case 4:
+		{
+			uint32 value;
+			memcpy(&value, src, 4);
+			*output_value = UInt32GetDatum(value);
+			break;
+		}
+#if SIZEOF_DATUM == 8
+		case 8:
+		{
+			memcpy(output_value, src, 8);
+			break;
+		}
+#endif
+		default:
+			pg_unreachable();
+	}
+	if (nullable)
+	{
+		Assert(validity != NULL);
+		*output_isnull = ((validity[arrow_row / 64] >> (arrow_row % 64)) & 1) == 0;
+	}
+	else
+	{
+		*output_isnull = false;
+	}
+}
+
+#define DEFINE_STORE_FIXED_VALUE(WIDTH)                                                            \
+	static void store_fixed_value_##WIDTH(const char *values, const uint64 *validity,              \
+										  uint16 arrow_row, Datum *output_value,                   \
+										  bool *output_isnull)                                     \
+	{                                                                                              \
+		store_fixed_value_impl(values,                                                             \
+							   validity,                                                           \
+							   arrow_row,                                                          \
+							   output_value,                                                       \
+							   output_isnull,                                                      \
+							   WIDTH,                                                              \
+							   /* nullable = */ false);                                            \
+	}                                                                                              \
+                                                                                                   \
+	static void store_fixed_value_nullable_##WIDTH(const char *values, const uint64 *validity,     \
+												   uint16 arrow_row, Datum *output_value,          \
+												   bool *output_isnull)                            \
+	{                                                                                              \
+		store_fixed_value_impl(values,                                                             \
+							   validity,                                                           \
+							   arrow_row,                                                          \
+							   output_value,                                                       \
+							   output_isnull,                                                      \
+							   WIDTH,                                                              \
+							   /* nullable = */ true);                                             \
+	}
+
+DEFINE_STORE_FIXED_VALUE(1)
+DEFINE_STORE_FIXED_VALUE(2)
+DEFINE_STORE_FIXED_VALUE(4)
+#if SIZEOF_DATUM == 8
+/*
+ * On 32-bit systems the 8-byte values don't fit into a Datum and are
+ * materialized by reference in the generic loop instead.
+ */
+DEFINE_STORE_FIXED_VALUE(8)
+#endif
+
+#undef DEFINE_STORE_FIXED_VALUE
+
+/*
+ * Look up the store function specialized for the given fixed value width and
+ * nullability. This runs once per column at batch setup, so that the per-row
+ * loop performs a single indirect call per column, which is well-predicted
+ * because the target is the same for a given column on each iteration.
+ */
+static FixedStoreFunction *
+get_fixed_store_function(int value_bytes, bool nullable)
+{
+	switch (value_bytes)
+	{
+		case 1:
+			return nullable ? store_fixed_value_nullable_1 : store_fixed_value_1;
+		case 2:
+			return nullable ? store_fixed_value_nullable_2 : store_fixed_value_2;
+		case 4:
+			return nullable ? store_fixed_value_nullable_4 : store_fixed_value_4;
+#if SIZEOF_DATUM == 8
+		case 8:
+			return nullable ? store_fixed_value_nullable_8 : store_fixed_value_8;
+#endif
+		default:
+			elog(ERROR, "unexpected fixed value width %d", value_bytes);
+			pg_unreachable();
+	}
+}
+
+/*
+ * Specialized version of make_next_tuple() for the common case where all
+ * columns of the batch are either fixed-width by-value arrow columns or
+ * scalars. The scalar values are already stored in the decompressed slot, so
+ * we only have to materialize the fixed-width columns, and the per-row loop
+ * becomes a single dense loop over the structure-of-arrays view of these
+ * columns, without the dispatch on the decompression type. This is much
+ * friendlier to the CPU than the generic loop, because for bulk-decompressed
+ * batches this loop runs for every row of every batch.
+ */
+static void
+make_next_tuple_fixed(DecompressBatchState *batch_state, uint16 arrow_row)
+{
+	const int num_fixed_columns = batch_state->num_fixed_columns;
+	const char *const *restrict values = batch_state->fixed_values;
+	const uint64 *const *restrict validity = batch_state->fixed_validity;
+	Datum *const *restrict output_value = batch_state->fixed_output_value;
+	bool *const *restrict output_isnull = batch_state->fixed_output_isnull;
+	FixedStoreFunction *const *restrict store_fn = batch_state->fixed_store_fn;
+
+#ifdef __GNUC__
+	const uint8 *restrict value_bytes = batch_state->fixed_value_bytes;
+#endif
+
+	for (int i = 0; i < num_fixed_columns; i++)
+	{
+#ifdef __GNUC__
+		/*
+		 * Each column is a separate sequential stream, so with many columns
+		 * the working set is one cache line per column, which can exceed what
+		 * the hardware prefetchers track. Prefetching one cache line ahead in
+		 * the value buffer hides this latency. Prefetching past the end of
+		 * the buffer is allowed and doesn't fault. The validity bitmaps are
+		 * not prefetched because an entire batch worth of validity bits fits
+		 * into two cache lines.
+		 */
+		__builtin_prefetch(&values[i][value_bytes[i] * arrow_row + 64]);
+#endif
+		store_fn[i](values[i], validity[i], arrow_row, output_value[i], output_isnull[i]);
+	}
+}
+
 /*
  * Construct the next tuple in the decompressed scan slot.
  * Doesn't check the quals.
@@ -1069,11 +1390,25 @@ store_text_datum(CompressedColumnValues *column_values, int arrow_row)
 static void
 make_next_tuple(DecompressBatchState *batch_state, uint16 arrow_row, int num_data_columns)
 {
-	TupleTableSlot *decompressed_scan_slot = &batch_state->decompressed_scan_slot_data.base;
+	PG_USED_FOR_ASSERTS_ONLY TupleTableSlot *decompressed_scan_slot =
+		&batch_state->decompressed_scan_slot_data.base;
 
 	Assert(batch_state->total_batch_rows > 0);
 	Assert(batch_state->next_batch_row < batch_state->total_batch_rows);
 
+	/*
+	 * The caller must have stored the virtual tuple already, this is done once
+	 * per batch instead of once per row.
+	 */
+	Assert(TTS_IS_VIRTUAL(decompressed_scan_slot));
+	Assert(!TTS_EMPTY(decompressed_scan_slot));
+
+	if (batch_state->only_fixed_columns)
+	{
+		make_next_tuple_fixed(batch_state, arrow_row);
+		return;
+	}
+
 	for (int i = 0; i < num_data_columns; i++)
 	{
 		CompressedColumnValues *column_values = &batch_state->compressed_columns[i];
@@ -1140,21 +1475,6 @@ make_next_tuple(DecompressBatchState *batch_state, uint16 arrow_row, int num_dat
 			Assert(column_values->decompression_type == DT_Scalar);
 		}
 	}
-
-	/*
-	 * It's a virtual tuple slot, so no point in clearing/storing it
-	 * per each row, we can just update the values in-place. This saves
-	 * some CPU. We have to store it after ExecQual returns false (the tuple
-	 * didn't pass the filter), or after a new batch. The standard protocol
-	 * is to clear and set the tuple slot for each row, but our output tuple
-	 * slots are read-only, and the memory is owned by this node, so it is
-	 * safe to violate this protocol.
-	 */
-	Assert(TTS_IS_VIRTUAL(decompressed_scan_slot));
-	if (TTS_EMPTY(decompressed_scan_slot))
-	{
-		ExecStoreVirtualTuple(decompressed_scan_slot);
-	}
 }
 
 static bool
@@ -1191,32 +1511,93 @@ postgres_qual(DecompressContext *dcontext, DecompressBatchState *batch_state)
 }
 
 /*
- * Decompress the next tuple from the batch indicated by batch state. The result is stored
- * in batch_state->decompressed_scan_slot. The slot will be empty if the batch
- * is entirely processed.
+ * The implementation of compressed_batch_advance(), specialized on the scan
+ * direction. The direction is constant for the entire scan, and specializing
+ * on it removes a data-dependent conditional from the per-row loop. This
+ * function is called from two callers with a constant argument, and is
+ * inlined into both of them.
  */
-void
-compressed_batch_advance(DecompressContext *dcontext, DecompressBatchState *batch_state)
+pg_attribute_always_inline static void
+compressed_batch_advance_impl(DecompressContext *dcontext, DecompressBatchState *batch_state,
+							  const bool reverse)
 {
 	Assert(batch_state->total_batch_rows > 0);
+	Assert(reverse == dcontext->reverse);
 
 	TupleTableSlot *decompressed_scan_slot = &batch_state->decompressed_scan_slot_data.base;
 
-	const bool reverse = dcontext->reverse;
 	const int num_data_columns = dcontext->num_data_columns;
 
-	for (; batch_state->next_batch_row < batch_state->total_batch_rows;
-		 batch_state->next_batch_row++)
+	if (unlikely(batch_state->vector_qual_no_rows_pass) && !batch_state->have_iterator_columns &&
+		batch_state->next_batch_row < batch_state->total_batch_rows)
+	{
+		/*
+		 * The vectorized quals filtered out the entire batch, and no columns
+		 * are decompressed row-by-row, so there are no iterators to keep in
+		 * sync and we can skip to the end-of-batch cleanup without looking at
+		 * the filter bitmap. This happens with batch sorted merge, which keeps
+		 * such batches open because it needs their first row for sorting.
+		 */
+		InstrCountFiltered1(dcontext->ps,
+							batch_state->total_batch_rows - batch_state->next_batch_row);
+		batch_state->next_batch_row = batch_state->total_batch_rows;
+	}
+
+	/*
+	 * It's a virtual tuple slot, so no point in clearing/storing it for each
+	 * row, we can just update the values in-place. This saves some CPU. The
+	 * slot is cleared after the batch ends, so we only have to store it here
+	 * once per call instead of checking for emptiness per row. The standard
+	 * protocol is to clear and set the tuple slot for each row, but our output
+	 * tuple slots are read-only, and the memory is owned by this node, so it
+	 * is safe to violate this protocol.
+	 */
+	Assert(TTS_IS_VIRTUAL(decompressed_scan_slot));
+	if (TTS_EMPTY(decompressed_scan_slot))
+	{
+		ExecStoreVirtualTuple(decompressed_scan_slot);
+	}
+
+	while (batch_state->next_batch_row < batch_state->total_batch_rows)
 	{
 		const uint16 output_row = batch_state->next_batch_row;
 		const uint16 arrow_row =
-			unlikely(reverse) ? batch_state->total_batch_rows - 1 - output_row : output_row;
+			reverse ? batch_state->total_batch_rows - 1 - output_row : output_row;
 
 		if (!vector_qual(batch_state, arrow_row))
 		{
+			if (!batch_state->have_iterator_columns)
+			{
+				/*
+				 * No columns are decompressed row-by-row, so we don't have to
+				 * advance any iterators and can skip directly to the next row
+				 * that passes the vectorized quals, jumping over the entire
+				 * words of the filter bitmap that are zero.
+				 */
+				const uint64 *filter = batch_state->vector_qual_result;
+				uint16 next_output_row;
+				if (reverse)
+				{
+					const int prev_arrow_row = bitmap_prev_set_bit(filter, arrow_row);
+					next_output_row = prev_arrow_row < 0 ?
+										  batch_state->total_batch_rows :
+										  batch_state->total_batch_rows - 1 - prev_arrow_row;
+				}
+				else
+				{
+					next_output_row =
+						bitmap_next_set_bit(filter, arrow_row, batch_state->total_batch_rows);
+				}
+				Assert(next_output_row > output_row);
+
+				InstrCountFiltered1(dcontext->ps, next_output_row - output_row);
+				batch_state->next_batch_row = next_output_row;
+				continue;
+			}
+
 			/*
 			 * This row doesn't pass the vectorized quals. Advance the iterated
-			 * compressed columns if we have any.
+			 * compressed columns.
 			 */
 			for (int i = 0; i < num_data_columns; i++)
 			{
@@ -1230,6 +1611,7 @@ compressed_batch_advance(DecompressContext *dcontext, DecompressBatchState *batc
 			}
 
 			InstrCountFiltered1(dcontext->ps, 1);
+			batch_state->next_batch_row++;
 			continue;
 		}
 
@@ -1242,6 +1624,7 @@ compressed_batch_advance(DecompressContext *dcontext, DecompressBatchState *batc
 			 * iteration.
 			 */
 			InstrCountFiltered1(dcontext->ps, 1);
+			batch_state->next_batch_row++;
 			continue;
 		}
 
@@ -1273,6 +1656,24 @@ compressed_batch_advance(DecompressContext *dcontext, DecompressBatchState *batc
 	ExecClearTuple(decompressed_scan_slot);
 }
 
+/*
+ * Decompress the next tuple from the batch indicated by batch state. The result is stored
+ * in batch_state->decompressed_scan_slot. The slot will be empty if the batch
+ * is entirely processed.
+ */
+void
+compressed_batch_advance(DecompressContext *dcontext, DecompressBatchState *batch_state)
+{
+	if (unlikely(dcontext->reverse))
+	{
+		compressed_batch_advance_impl(dcontext, batch_state, /* reverse = */ true);
+	}
+	else
+	{
+		compressed_batch_advance_impl(dcontext, batch_state, /* reverse = */ false);
+	}
+}
+
 /*
  * Before loading the first matching tuple from the batch, also save the very
  * first one into the given slot, even if it doesn't pass the quals. This is
@@ -1303,9 +1704,15 @@ compressed_batch_save_first_tuple(DecompressContext *dcontext, DecompressBatchSt
 
 	/* Make the first tuple and save it. */
 	Assert(batch_state->next_batch_row == 0);
+	TupleTableSlot *decompressed_scan_slot = &batch_state->decompressed_scan_slot_data.base;
+	Assert(TTS_IS_VIRTUAL(decompressed_scan_slot));
+	if (TTS_EMPTY(decompressed_scan_slot))
+	{
+		ExecStoreVirtualTuple(decompressed_scan_slot);
+	}
 	const uint16 arrow_row = dcontext->reverse ? batch_state->total_batch_rows - 1 : 0;
 	make_next_tuple(batch_state, arrow_row, dcontext->num_data_columns);
-	ExecCopySlot(first_tuple_slot, &batch_state->decompressed_scan_slot_data.base);
+	ExecCopySlot(first_tuple_slot, decompressed_scan_slot);
 
 	/*
 	 * Check the quals and advance, so that the batch is in the correct state
@@ -1349,4 +1756,11 @@ compressed_batch_destroy(DecompressBatchState *batch_state)
 		pfree(batch_state->decompressed_scan_slot_data.base.tts_values);
 		batch_state->decompressed_scan_slot_data.base.tts_values = NULL;
 	}
+
+	if (batch_state->vector_qual_result_storage != NULL)
+	{
+		pfree(batch_state->vector_qual_result_storage);
+		batch_state->vector_qual_result_storage = NULL;
+		batch_state->vector_qual_storage_words = 0;
+	}
 }
@@ -71,6 +71,19 @@ typedef struct DecompressContext
 	/* This excludes the metadata columns. */
 	int num_data_columns;
 
+	/*
+	 * Maps an attno to the index of the respective data column in
+	 * compressed_chunk_columns, or -1 if the attno has no data column. There
+	 * is one map for each attno space a qual Var can reference: the custom
+	 * scan tuple and the uncompressed chunk tuple. The arrays are indexed by
+	 * attno and sized to the number of attributes of the respective tuple
+	 * descriptor plus one. This gives O(1) lookup of the columns referenced
+	 * by the vectorized quals, instead of a linear search over the columns
+	 * per qual per batch.
+	 */
+	int16 *column_index_by_custom_attno;
+	int16 *column_index_by_chunk_attno;
+
 	List *vectorized_quals_constified;
 	bool reverse;
 	bool batch_sorted_merge; /* Merge append optimization enabled */
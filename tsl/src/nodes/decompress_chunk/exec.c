@@ -353,6 +353,32 @@ decompress_chunk_begin(CustomScanState *node, EState *estate, int eflags)
 	Assert(current_compressed == num_data_columns);
 	Assert(current_not_compressed == num_columns_with_metadata);
 
+	/*
+	 * Build the lookup tables from the attnos to the data column indexes,
+	 * used for O(1) lookup of the columns referenced by the vectorized quals.
+	 */
+	const int num_custom_attnos = desc->natts;
+	const int num_chunk_attnos = dcontext->uncompressed_chunk_tdesc->natts;
+	dcontext->column_index_by_custom_attno = palloc(sizeof(int16) * (num_custom_attnos + 1));
+	dcontext->column_index_by_chunk_attno = palloc(sizeof(int16) * (num_chunk_attnos + 1));
+	for (int i = 0; i <= num_custom_attnos; i++)
+	{
+		dcontext->column_index_by_custom_attno[i] = -1;
+	}
+	for (int i = 0; i <= num_chunk_attnos; i++)
+	{
+		dcontext->column_index_by_chunk_attno[i] = -1;
+	}
+	for (int i = 0; i < num_data_columns; i++)
+	{
+		const CompressionColumnDescription *column = &dcontext->compressed_chunk_columns[i];
+		Assert(column->custom_scan_attno > 0 && column->custom_scan_attno <= num_custom_attnos);
+		Assert(column->uncompressed_chunk_attno > 0 &&
+			   column->uncompressed_chunk_attno <= num_chunk_attnos);
+		dcontext->column_index_by_custom_attno[column->custom_scan_attno] = i;
+		dcontext->column_index_by_chunk_attno[column->uncompressed_chunk_attno] = i;
+	}
+
 	/*
 	 * Choose which batch queue we are going to use: heap for batch sorted
 	 * merge, and one-element FIFO for normal decompression.
@@ -8,7 +8,9 @@
  * Compute a vector-const predicate and AND it to the filter bitmap.
  * Specialized for particular arithmetic data types and predicate.
  * Marked as noinline for the ease of debugging. Inlining it shouldn't be
- * beneficial because it's a big self-contained loop.
+ * beneficial because it's a big self-contained loop. The loop is cloned per
+ * instruction set extension where supported, so that it is autovectorized
+ * with the full vector width of the host CPU.
  */
 
 #define PG_PREDICATE_HELPER(X) PG_PREDICATE(X)
@@ -21,7 +23,7 @@ case PG_PREDICATE_HELPER(PREDICATE_NAME):
 	return FUNCTION_NAME(PREDICATE_NAME, VECTOR_CTYPE, CONST_CTYPE);
 #else
 
-static pg_noinline void
+static pg_noinline TS_TARGET_CLONES void
 FUNCTION_NAME(PREDICATE_NAME, VECTOR_CTYPE,
 			  CONST_CTYPE)(const ArrowArray *arrow, const Datum constdatum, uint64 *restrict result)
 {
@@ -18,6 +18,7 @@
 
 #include "vector_predicates.h"
 
+#include "annotations.h"
 #include "compat/compat.h"
 #include "compression/compression.h"
 #include "debug_assert.h"
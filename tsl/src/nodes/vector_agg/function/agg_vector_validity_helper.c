@@ -7,7 +7,10 @@
 /*
  * Generate a separate implementation of aggregating an ArrowArray for the
  * common cases where we have no nulls and/or all rows pass the filter. It
- * avoids branches so can be more easily vectorized.
+ * avoids branches so can be more easily vectorized. These outlined functions
+ * are also cloned per instruction set extension where supported, so that the
+ * aggregation loop inlined into them is autovectorized with the full vector
+ * width of the host CPU.
  */
 
 static pg_attribute_always_inline void
@@ -19,14 +22,14 @@ FUNCTION_NAME(vector_impl_arrow)(void *agg_state, const ArrowArray *vector, cons
 	FUNCTION_NAME(vector_impl)(agg_state, n, values, filter, agg_extra_mctx);
 }
 
-static pg_noinline void
+static pg_noinline TS_TARGET_CLONES void
 FUNCTION_NAME(vector_all_valid)(void *agg_state, const ArrowArray *vector,
 								MemoryContext agg_extra_mctx)
 {
 	FUNCTION_NAME(vector_impl_arrow)(agg_state, vector, NULL, agg_extra_mctx);
 }
 
-static pg_noinline void
+static pg_noinline TS_TARGET_CLONES void
 FUNCTION_NAME(vector_one_validity)(void *agg_state, const ArrowArray *vector, const uint64 *filter,
 								   MemoryContext agg_extra_mctx)
 {
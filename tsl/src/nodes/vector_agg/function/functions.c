@@ -16,6 +16,7 @@
 
 #include "functions.h"
 
+#include "annotations.h"
 #include "compat/compat.h"
 
 /*